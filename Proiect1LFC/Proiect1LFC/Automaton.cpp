@@ -64,14 +64,14 @@ bool RegularExpression::Automaton::verifyAutomaton() const {
 		for (const auto& [symbol, targetStates] : transitions) {
 			// 5.2 Check if the symbol exists in the alphabet
 			if (m_alphabet.find(symbol) == m_alphabet.end()) {
-				std::cerr << "Error: The symbol '" << symbol
+				std::cerr << "Error: The symbol '" << GetSymbolName(symbol)
 					<< "' in the transition function is not part of the alphabet." << std::endl;
 				return false;
 			}
 
 			// 5.3 Check if the automaton is deterministic
 			if (targetStates.size() != 1) {
-				std::cerr << "Error: The transition for state '" << state << "' and symbol '" << symbol
+				std::cerr << "Error: The transition for state '" << state << "' and symbol '" << GetSymbolName(symbol)
 					<< "' is not deterministic (targetStates.size() = " << targetStates.size() << ")." << std::endl;
 				return false;
 			}
@@ -135,6 +135,11 @@ bool RegularExpression::Automaton::CheckWord(const std::string& word)
 	return false;
 }
 
+size_t RegularExpression::Automaton::GetStatesCount() const
+{
+	return m_states.size();
+}
+
 Automaton RegularExpression::Automaton::GetDFA()
 {
 	Automaton DFAAutomaton;
@@ -156,8 +161,8 @@ Automaton RegularExpression::Automaton::GetDFA()
 			std::unordered_set<std::string> transitionStates = GetTransitionStates(newState, operand);
 			std::unordered_set<std::string> lambdaClosures = GetLambdaClosures(transitionStates);
 			if (lambdaClosures.empty()) continue;
+			DFAAutomaton.m_alphabet.insert(operand);
 			if (newStates.find(lambdaClosures) == newStates.end()) {
-				DFAAutomaton.m_alphabet.insert(operand);
 				newStates[lambdaClosures] = "q" + std::to_string(newStates.size());
 				newStatesQueue.push(lambdaClosures);
 				DFAAutomaton.m_states.insert(newStates[lambdaClosures]);
@@ -205,6 +210,16 @@ std::unordered_set<std::string> RegularExpression::Automaton::GetLambdaClosures(
 	return lambdaClosures;
 }
 
+std::string RegularExpression::Automaton::GetSymbolName(const char& symbol) const
+{
+	// UTF-8 bytes are not printable on their own, show them as hex escapes
+	if (symbol == kLambda) return "lambda";
+	const unsigned char byte = static_cast<unsigned char>(symbol);
+	if (byte < 0x80) return std::string(1, symbol);
+	const char* digits = "0123456789ABCDEF";
+	return std::string("\\x") + digits[byte >> 4] + digits[byte & 0xF];
+}
+
 std::unordered_set<std::string> RegularExpression::Automaton::GetTransitionStates(const std::unordered_set<std::string>& states, const char& operand)
 {
 	std::unordered_set<std::string> transitionStates;
@@ -231,8 +246,7 @@ std::ostream& RegularExpression::operator<<(std::ostream& os, const Automaton& a
 	}
 	os << "\nALPHABET:\n";
 	for (const char& ch : automaton.m_alphabet) {
-		if (ch == automaton.kLambda) os << "lambda ";
-		else os << ch << " ";
+		os << automaton.GetSymbolName(ch) << " ";
 	}
 	os << "\nINITIAL STATE: " << automaton.m_initialState << "\n";
 	os << "FINAL STATES:\n";
@@ -250,8 +264,7 @@ std::ostream& RegularExpression::operator<<(std::ostream& os, const Automaton& a
 		if (automaton.m_transitionFunction.find(currentState) == automaton.m_transitionFunction.end()) continue;
 		for (const auto& [operand,nextState] : automaton.m_transitionFunction.at(currentState)) {
 			for (const std::string& next : nextState) {
-				if (operand == automaton.kLambda) os << "function(" << currentState << ",lambda) = " << next << "\n";
-				else os << "function(" << currentState << "," << operand << ") = " << next << "\n";
+				os << "function(" << currentState << "," << automaton.GetSymbolName(operand) << ") = " << next << "\n";
 				if (closedList.find(next) == closedList.end()) {
 					queue.push(next);
 					closedList.insert(next);
@@ -345,6 +358,66 @@ Automaton RegularExpression::KleeneStructure(const Automaton& automaton, size_t
 	return result;
 }
 
+Automaton RegularExpression::CodePointStructure(const std::vector<CodePointRange>& ranges, size_t currentStatesCount)
+{
+	Automaton result;
+	std::string newInitial = "q" + std::to_string(currentStatesCount);
+	std::string newFinal = "q" + std::to_string(currentStatesCount + 1);
+	result.m_states.insert(newInitial);
+	result.m_states.insert(newFinal);
+	result.m_initialState = newInitial;
+	result.m_finalStates.insert(newFinal);
+
+	// Sort and merge the ranges so overlapping intervals don't produce duplicate paths
+	std::vector<CodePointRange> merged = ranges;
+	std::sort(merged.begin(), merged.end());
+	std::vector<CodePointRange> normalized;
+	for (const CodePointRange& range : merged) {
+		if (!normalized.empty() && range.first <= normalized.back().second + 1) {
+			normalized.back().second = std::max(normalized.back().second, range.second);
+			continue;
+		}
+		normalized.push_back(range);
+	}
+
+	// Split every interval into byte range sequences of equal encoded length
+	std::vector<ByteRangeSequence> sequences;
+	for (const CodePointRange& range : normalized) {
+		splitUtf8Range(range.first, range.second, sequences);
+	}
+
+	auto addByteTransitions = [&result](const std::string& from, const ByteRange& bytes, const std::string& to) {
+		for (unsigned int byte = bytes.first; byte <= bytes.second; ++byte) {
+			result.m_alphabet.insert(static_cast<char>(byte));
+			result.m_transitionFunction[from][static_cast<char>(byte)].insert(to);
+		}
+	};
+
+	// Build every sequence backwards from the final state, reusing a state whenever
+	// the same byte range already leads to the same suffix (continuation bytes are shared a lot)
+	std::map<std::tuple<unsigned char, unsigned char, std::string>, std::string> suffixes;
+	for (const ByteRangeSequence& sequence : sequences) {
+		std::string next = newFinal;
+		for (size_t index = sequence.size() - 1; index > 0; --index) {
+			const ByteRange& bytes = sequence[index];
+			auto key = std::make_tuple(bytes.first, bytes.second, next);
+			auto found = suffixes.find(key);
+			if (found != suffixes.end()) {
+				next = found->second;
+				continue;
+			}
+			std::string newState = "q" + std::to_string(currentStatesCount + result.m_states.size());
+			result.m_states.insert(newState);
+			addByteTransitions(newState, bytes, next);
+			suffixes[key] = newState;
+			next = newState;
+		}
+		addByteTransitions(newInitial, sequence.front(), next);
+	}
+
+	return result;
+}
+
 //Functions
 
 
@@ -386,6 +459,26 @@ Automaton RegularExpression::getLambdaNFA(const std::string& polish)
 			statesCount += 2;
 			continue;
 		}
+		// For a UTF-8 encoded character, build its byte sequence
+		if (isUtf8LeadByte(current)) {
+			char32_t codePoint = 0;
+			size_t next = index;
+			decodeUtf8(polish, next, codePoint);
+			stack.push(CodePointStructure({ { codePoint, codePoint } }, statesCount));
+			statesCount += stack.top().GetStatesCount();
+			index = next - 1;
+			continue;
+		}
+		// For a character class, build the byte sequences of all its ranges
+		if (current == '[') {
+			size_t closing = polish.find(']', index);
+			std::vector<CodePointRange> ranges;
+			parseCodePointClass(polish.substr(index + 1, closing - index - 1), ranges);
+			stack.push(CodePointStructure(ranges, statesCount));
+			statesCount += stack.top().GetStatesCount();
+			index = closing;
+			continue;
+		}
 		if (current == '|') {
 			Automaton first = stack.top(); stack.pop();
 			Automaton second = stack.top(); stack.pop();
@@ -434,12 +527,37 @@ int RegularExpression::getPriority(const char& c) {
 std::string RegularExpression::polishPostfixNotation(const std::string& inputExpression) {
 	std::stack<char> op_stack;
 	std::string polishNotation;
-	for (const char& current : inputExpression) {
+	for (size_t index = 0; index < inputExpression.size(); ++index) {
+		const char& current = inputExpression[index];
 		if (current == ' ') continue;
 		if (isOperand(current)) {
 			polishNotation.push_back(current);
 			continue;
 		}
+		// Multi-byte characters are copied whole, so getLambdaNFA can decode them again
+		if (static_cast<unsigned char>(current) >= 0x80) {
+			char32_t codePoint = 0;
+			size_t next = index;
+			if (!decodeUtf8(inputExpression, next, codePoint)) {
+				std::cerr << "Invalid expression! Invalid UTF-8 sequence!\n";
+				return "";
+			}
+			polishNotation.append(inputExpression, index, next - index);
+			index = next - 1;
+			continue;
+		}
+		// Character classes are operands too, copied with their brackets
+		if (current == '[') {
+			size_t closing = inputExpression.find(']', index);
+			std::vector<CodePointRange> ranges;
+			if (closing == std::string::npos || !parseCodePointClass(inputExpression.substr(index + 1, closing - index - 1), ranges)) {
+				std::cerr << "Invalid expression! Character class error!\n";
+				return "";
+			}
+			polishNotation.append(inputExpression, index, closing - index + 1);
+			index = closing;
+			continue;
+		}
 		if (current == '(') {
 			op_stack.push(current);
 			continue;
@@ -476,4 +594,130 @@ std::string RegularExpression::polishPostfixNotation(const std::string& inputExp
 		op_stack.pop();
 	}
 	return polishNotation;
-}
\ No newline at end of file
+}
+
+
+
+
+
+/////////UTF-8
+
+
+bool RegularExpression::isUtf8LeadByte(const char& c) {
+	return utf8SequenceLength(c) > 1;
+}
+
+size_t RegularExpression::utf8SequenceLength(const char& leadByte) {
+	const unsigned char byte = static_cast<unsigned char>(leadByte);
+	if (byte < 0x80) return 1;
+	if (byte >= 0xC2 && byte <= 0xDF) return 2;
+	if (byte >= 0xE0 && byte <= 0xEF) return 3;
+	if (byte >= 0xF0 && byte <= 0xF4) return 4;
+	return 0; // continuation byte or a lead byte that can never be valid
+}
+
+bool RegularExpression::decodeUtf8(const std::string& text, size_t& index, char32_t& codePoint) {
+	size_t length = utf8SequenceLength(text[index]);
+	if (length == 0 || index + length > text.size()) return false;
+	const unsigned char lead = static_cast<unsigned char>(text[index]);
+	if (length == 1) codePoint = lead;
+	else codePoint = lead & (0xFF >> (length + 1));
+	for (size_t offset = 1; offset < length; ++offset) {
+		const unsigned char byte = static_cast<unsigned char>(text[index + offset]);
+		if ((byte & 0xC0) != 0x80) return false;
+		codePoint = (codePoint << 6) | (byte & 0x3F);
+	}
+	// Reject overlong encodings, surrogates and values past the Unicode range
+	if (length == 3 && codePoint < 0x800) return false;
+	if (length == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)) return false;
+	if (codePoint >= 0xD800 && codePoint <= 0xDFFF) return false;
+	index += length;
+	return true;
+}
+
+std::string RegularExpression::encodeUtf8(char32_t codePoint) {
+	std::string encoded;
+	if (codePoint < 0x80) {
+		encoded.push_back(static_cast<char>(codePoint));
+	}
+	else if (codePoint < 0x800) {
+		encoded.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+		encoded.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else if (codePoint < 0x10000) {
+		encoded.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		encoded.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		encoded.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else {
+		encoded.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		encoded.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		encoded.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		encoded.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	return encoded;
+}
+
+bool RegularExpression::parseCodePointClass(const std::string& body, std::vector<CodePointRange>& ranges) {
+	// body is the text between '[' and ']', a list of characters and lo-hi ranges
+	if (body.empty()) return false;
+	size_t index = 0;
+	while (index < body.size()) {
+		char32_t lo = 0;
+		if (!decodeUtf8(body, index, lo)) return false;
+		if (lo == 0) return false; // byte 0x00 is kLambda, it can't be matched
+		char32_t hi = lo;
+		if (index + 1 < body.size() && body[index] == '-') {
+			++index;
+			if (!decodeUtf8(body, index, hi)) return false;
+			if (hi < lo) return false;
+		}
+		ranges.push_back({ lo, hi });
+	}
+	return true;
+}
+
+void RegularExpression::splitUtf8Range(char32_t lo, char32_t hi, std::vector<ByteRangeSequence>& sequences) {
+	// Surrogates have no valid encoding, so they are cut out of the interval
+	if (lo <= 0xDFFF && hi >= 0xD800) {
+		if (lo < 0xD800) splitUtf8Range(lo, 0xD7FF, sequences);
+		if (hi > 0xDFFF) splitUtf8Range(0xE000, hi, sequences);
+		return;
+	}
+	// Split where the encoded length changes
+	for (char32_t max : { 0x7Fu, 0x7FFu, 0xFFFFu }) {
+		if (lo <= max && max < hi) {
+			splitUtf8Range(lo, max, sequences);
+			splitUtf8Range(max + 1, hi, sequences);
+			return;
+		}
+	}
+	// ASCII is a single byte range
+	if (hi < 0x80) {
+		sequences.push_back({ { static_cast<unsigned char>(lo), static_cast<unsigned char>(hi) } });
+		return;
+	}
+	// Split until every continuation byte below the first differing one spans its full 80-BF range
+	for (size_t shift = 6; shift <= 18; shift += 6) {
+		const char32_t mask = (char32_t(1) << shift) - 1;
+		if ((lo & ~mask) == (hi & ~mask)) continue;
+		if ((lo & mask) != 0) {
+			splitUtf8Range(lo, lo | mask, sequences);
+			splitUtf8Range((lo | mask) + 1, hi, sequences);
+			return;
+		}
+		if ((hi & mask) != mask) {
+			splitUtf8Range(lo, (hi & ~mask) - 1, sequences);
+			splitUtf8Range(hi & ~mask, hi, sequences);
+			return;
+		}
+	}
+	// Both ends now have the same length, and the byte ranges between them are independent
+	std::string first = encodeUtf8(lo);
+	std::string last = encodeUtf8(hi);
+	ByteRangeSequence sequence;
+	for (size_t index = 0; index < first.size(); ++index) {
+		sequence.push_back({ static_cast<unsigned char>(first[index]), static_cast<unsigned char>(last[index]) });
+	}
+	sequences.push_back(sequence);
+}
@@ -8,10 +8,20 @@
 #include <queue>
 #include <iostream>
 #include <utility>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <algorithm>
 
 
 namespace RegularExpression {
 
+	using CodePointRange = std::pair<char32_t, char32_t>; //inclusive interval of Unicode code points
+	using ByteRange = std::pair<unsigned char, unsigned char>; //inclusive interval of bytes
+	using ByteRangeSequence = std::vector<ByteRange>; //one UTF-8 encoded interval, one range per byte
+
+	class CompiledAutomaton;
+
 
 
 	class Automaton
@@ -33,6 +43,7 @@ namespace RegularExpression {
 	public:
 		bool verifyAutomaton() const;
 		bool CheckWord(const std::string& word);
+		size_t GetStatesCount() const;
 		friend std::ostream& operator<<(std::ostream& os, const Automaton& automaton);
 
 		Automaton GetDFA();
@@ -42,12 +53,19 @@ namespace RegularExpression {
 		friend Automaton OrStructure(const Automaton& lhs, const Automaton& rhs, size_t currentStatesCount);
 		friend Automaton AndStructure(const Automaton& lhs, const Automaton& rhs);
 		friend Automaton KleeneStructure(const Automaton& automaton, size_t currentStatesCount);
+		friend Automaton CodePointStructure(const std::vector<CodePointRange>& ranges, size_t currentStatesCount);
+
+		//Flattening DFA
+		friend class CompiledAutomaton;
 
 	private:
 		//Building DFA
 		std::unordered_set<std::string> GetLambdaClosures(const std::unordered_set<std::string>& states);
 		std::unordered_set<std::string> GetTransitionStates(const std::unordered_set<std::string>& states, const char& operand);
 
+		//Printing
+		std::string GetSymbolName(const char& symbol) const;
+
 		//Constants
 	private:
 		char kLambda = '\0';
@@ -90,6 +108,15 @@ namespace RegularExpression {
 
 	Automaton getLambdaNFA(const std::string& polish);
 
+	//UTF-8
+
+	bool isUtf8LeadByte(const char& c);
+	size_t utf8SequenceLength(const char& leadByte);
+	bool decodeUtf8(const std::string& text, size_t& index, char32_t& codePoint);
+	std::string encodeUtf8(char32_t codePoint);
+	bool parseCodePointClass(const std::string& body, std::vector<CodePointRange>& ranges);
+	void splitUtf8Range(char32_t lo, char32_t hi, std::vector<ByteRangeSequence>& sequences);
+
 
 	//Template Functions
 
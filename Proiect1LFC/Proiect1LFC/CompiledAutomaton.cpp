@@ -0,0 +1,339 @@
+#include "CompiledAutomaton.h"
+
+#if REGULAR_EXPRESSION_JIT
+#include <sys/mman.h>
+#include <functional>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+using namespace RegularExpression;
+
+//COMPILED AUTOMATON
+
+
+
+RegularExpression::CompiledAutomaton::CompiledAutomaton(const Automaton& dfa, bool enableJit)
+{
+	if (dfa.m_initialState.empty()) {
+		std::cerr << "Could not compile automaton! It has no initial state!\n";
+		return;
+	}
+
+	// Number the states in BFS order from the initial state, so the initial state is 0
+	std::unordered_map<std::string, int32_t> indices;
+	std::vector<std::string> order;
+	std::queue<std::string> queue;
+	indices[dfa.m_initialState] = 0;
+	queue.push(dfa.m_initialState);
+	m_table.assign(kAlphabetSize, kDeadState);
+
+	while (!queue.empty()) {
+		std::string currentState = queue.front(); queue.pop();
+		order.push_back(currentState);
+		if (dfa.m_transitionFunction.find(currentState) == dfa.m_transitionFunction.end()) continue;
+		for (const auto& [operand, nextStates] : dfa.m_transitionFunction.at(currentState)) {
+			if (operand == dfa.kLambda || nextStates.size() != 1) {
+				std::cerr << "Could not compile automaton! NOT DFA!\n";
+				m_table.clear();
+				return;
+			}
+			const std::string& next = *nextStates.begin();
+			if (indices.find(next) == indices.end()) {
+				indices[next] = static_cast<int32_t>(indices.size());
+				m_table.resize(indices.size() * kAlphabetSize, kDeadState);
+				queue.push(next);
+			}
+			m_table[indices[currentState] * kAlphabetSize + static_cast<unsigned char>(operand)] = indices[next];
+		}
+	}
+
+	m_finalStates.assign(order.size(), false);
+	for (size_t index = 0; index < order.size(); ++index) {
+		m_finalStates[index] = dfa.m_finalStates.find(order[index]) != dfa.m_finalStates.end();
+	}
+	m_initialState = 0;
+
+	if (enableJit) CompileNative();
+}
+
+RegularExpression::CompiledAutomaton::NativeCode::~NativeCode()
+{
+#if REGULAR_EXPRESSION_JIT
+	if (memory != nullptr) munmap(memory, size);
+#endif
+}
+
+
+// Methods
+
+
+bool RegularExpression::CompiledAutomaton::CheckWord(const std::string& word) const
+{
+	if (m_nativeCode == nullptr) return CheckWordInterpreted(word);
+	const unsigned char* begin = reinterpret_cast<const unsigned char*>(word.data());
+	return m_nativeCode->entry(begin, begin + word.size());
+}
+
+bool RegularExpression::CompiledAutomaton::CheckWordInterpreted(const std::string& word) const
+{
+	if (m_finalStates.empty()) return false; // failed to compile, or moved from
+	int32_t currState = m_initialState;
+	for (const char& currCh : word) {
+		currState = m_table[currState * kAlphabetSize + static_cast<unsigned char>(currCh)];
+		if (currState == kDeadState) return false;
+	}
+	return m_finalStates[currState];
+}
+
+bool RegularExpression::CompiledAutomaton::IsJitCompiled() const
+{
+	return m_nativeCode != nullptr;
+}
+
+size_t RegularExpression::CompiledAutomaton::GetStatesCount() const
+{
+	return m_finalStates.size();
+}
+
+int32_t RegularExpression::CompiledAutomaton::GetInitialState() const
+{
+	return m_finalStates.empty() ? kDeadState : m_initialState;
+}
+
+int32_t RegularExpression::CompiledAutomaton::GetNextState(int32_t state, unsigned char byte) const
+{
+	if (state == kDeadState) return kDeadState;
+	return m_table[state * kAlphabetSize + byte];
+}
+
+bool RegularExpression::CompiledAutomaton::IsFinalState(int32_t state) const
+{
+	return state != kDeadState && m_finalStates[state];
+}
+
+
+
+
+//////////////NATIVE CODE
+
+
+#if REGULAR_EXPRESSION_JIT
+
+namespace {
+
+	// Machine code buffer with labels that are resolved once every block is placed
+	struct CodeBuffer {
+	public:
+		std::vector<unsigned char> bytes;
+		std::vector<int64_t> labels; //offset of every label, -1 while unplaced
+		std::vector<std::pair<size_t, size_t>> relativeFixups; //(position of rel32, label)
+		std::vector<std::tuple<size_t, size_t, size_t>> tableFixups; //(position of entry, label, table start)
+
+		size_t newLabel() {
+			labels.push_back(-1);
+			return labels.size() - 1;
+		}
+		void emit(std::initializer_list<unsigned char> code) {
+			bytes.insert(bytes.end(), code);
+		}
+		void emit32(int32_t value) {
+			for (size_t index = 0; index < 4; ++index) bytes.push_back(static_cast<unsigned char>(value >> (8 * index)));
+		}
+		void place(size_t label) {
+			labels[label] = static_cast<int64_t>(bytes.size());
+		}
+		void jumpTo(size_t label) {
+			relativeFixups.push_back({ bytes.size(), label });
+			emit32(0);
+		}
+		void patch32(size_t position, int32_t value) {
+			for (size_t index = 0; index < 4; ++index) bytes[position + index] = static_cast<unsigned char>(value >> (8 * index));
+		}
+		void resolve() {
+			for (const auto& [position, label] : relativeFixups) {
+				patch32(position, static_cast<int32_t>(labels[label] - static_cast<int64_t>(position + 4)));
+			}
+			for (const auto& [position, label, tableStart] : tableFixups) {
+				patch32(position, static_cast<int32_t>(labels[label] - static_cast<int64_t>(tableStart)));
+			}
+		}
+	};
+
+}
+
+void RegularExpression::CompiledAutomaton::CompileNative()
+{
+	const size_t statesCount = m_finalStates.size();
+	if (statesCount == 0 || statesCount > kMaxJitStates) return;
+
+	// Distinct targets of every state; byte -> class (0 = reject, k = targets[k - 1]) must fit in a byte
+	std::vector<std::vector<int32_t>> classTargets(statesCount);
+	for (size_t state = 0; state < statesCount; ++state) {
+		for (size_t byte = 0; byte < kAlphabetSize; ++byte) {
+			int32_t next = m_table[state * kAlphabetSize + byte];
+			if (next == kDeadState) continue;
+			if (std::find(classTargets[state].begin(), classTargets[state].end(), next) == classTargets[state].end()) {
+				classTargets[state].push_back(next);
+			}
+		}
+		if (classTargets[state].size() > 0xFF) return;
+	}
+
+	// Every state gets a checked block (bounds check per byte, used for the tail of the input)
+	// and kUnrollFactor unchecked copies; copy k moves to copy k+1 of the next state and
+	// only copy 0 checks that kUnrollFactor more bytes are available.
+	// Registers: rdi = current byte, rsi = end, r8 = end - kUnrollFactor.
+	// Lookup tables live on read-only pages after the code: one byte -> class map per state,
+	// shared by its five blocks, and one small rel32 table of class targets per block.
+	CodeBuffer code;
+	std::vector<size_t> checkedLabels(statesCount);
+	std::vector<std::vector<size_t>> unrolledLabels(statesCount, std::vector<size_t>(kUnrollFactor));
+	for (size_t state = 0; state < statesCount; ++state) {
+		checkedLabels[state] = code.newLabel();
+		for (size_t& label : unrolledLabels[state]) label = code.newLabel();
+	}
+	const size_t rejectLabel = code.newLabel();
+	std::vector<std::pair<size_t, size_t>> classMaps; //(label, state)
+	std::vector<std::pair<size_t, std::vector<size_t>>> targetTables; //(label, label of every class)
+	std::vector<size_t> classMapLabels(statesCount, rejectLabel);
+
+	// Prologue
+	code.emit({ 0x49, 0x89, 0xF0 }); // mov r8, rsi
+	code.emit({ 0x49, 0x83, 0xE8, static_cast<unsigned char>(kUnrollFactor) }); // sub r8, kUnrollFactor
+	code.emit({ 0xE9 }); code.jumpTo(unrolledLabels[m_initialState][0]); // jmp initial state
+
+	// Emit the transitions of one state to the blocks given by targetLabel
+	auto emitDispatch = [&](size_t state, const std::function<size_t(size_t)>& targetLabel) {
+		std::vector<std::tuple<unsigned int, unsigned int, int32_t>> ranges;
+		for (unsigned int byte = 0; byte < kAlphabetSize; ++byte) {
+			int32_t next = m_table[state * kAlphabetSize + byte];
+			if (next == kDeadState) continue;
+			if (!ranges.empty() && std::get<1>(ranges.back()) + 1 == byte && std::get<2>(ranges.back()) == next) {
+				std::get<1>(ranges.back()) = byte;
+				continue;
+			}
+			ranges.push_back({ byte, byte, next });
+		}
+
+		code.emit({ 0x0F, 0xB6, 0x07 }); // movzx eax, byte [rdi]
+		code.emit({ 0x48, 0xFF, 0xC7 }); // inc rdi
+
+		if (ranges.size() <= kMaxCompareChain) {
+			for (const auto& [lo, hi, next] : ranges) {
+				if (lo == hi) {
+					code.emit({ 0x3C, static_cast<unsigned char>(lo) }); // cmp al, lo
+					code.emit({ 0x0F, 0x84 }); code.jumpTo(targetLabel(next)); // je next
+				}
+				else {
+					code.emit({ 0x8D, 0x88 }); code.emit32(-static_cast<int32_t>(lo)); // lea ecx, [rax - lo]
+					code.emit({ 0x81, 0xF9 }); code.emit32(static_cast<int32_t>(hi - lo)); // cmp ecx, hi - lo
+					code.emit({ 0x0F, 0x86 }); code.jumpTo(targetLabel(next)); // jbe next
+				}
+			}
+			code.emit({ 0xE9 }); code.jumpTo(rejectLabel); // jmp reject
+			return;
+		}
+
+		if (classMapLabels[state] == rejectLabel) {
+			classMapLabels[state] = code.newLabel();
+			classMaps.push_back({ classMapLabels[state], state });
+		}
+		code.emit({ 0x48, 0x8D, 0x0D }); code.jumpTo(classMapLabels[state]); // lea rcx, [rip + class map]
+
+		// A single target (e.g. a character class loop) only needs to know if the byte is accepted,
+		// so the one branch left is the rarely taken reject
+		if (classTargets[state].size() == 1) {
+			code.emit({ 0x80, 0x3C, 0x01, 0x00 }); // cmp byte [rcx + rax], 0
+			code.emit({ 0x0F, 0x84 }); code.jumpTo(rejectLabel); // je reject
+			code.emit({ 0xE9 }); code.jumpTo(targetLabel(classTargets[state].front())); // jmp next
+			return;
+		}
+
+		std::vector<size_t> classLabels = { rejectLabel };
+		for (int32_t next : classTargets[state]) classLabels.push_back(targetLabel(next));
+		targetTables.push_back({ code.newLabel(), classLabels });
+		code.emit({ 0x0F, 0xB6, 0x04, 0x01 }); // movzx eax, byte [rcx + rax]
+		code.emit({ 0x48, 0x8D, 0x0D }); code.jumpTo(targetTables.back().first); // lea rcx, [rip + target table]
+		code.emit({ 0x48, 0x63, 0x04, 0x81 }); // movsxd rax, dword [rcx + rax * 4]
+		code.emit({ 0x48, 0x01, 0xC8 }); // add rax, rcx
+		code.emit({ 0xFF, 0xE0 }); // jmp rax
+	};
+
+	for (size_t state = 0; state < statesCount; ++state) {
+		const unsigned char isFinal = m_finalStates[state] ? 1 : 0;
+
+		// Checked block
+		code.place(checkedLabels[state]);
+		code.emit({ 0x48, 0x39, 0xF7 }); // cmp rdi, rsi
+		code.emit({ 0x72, 0x06 }); // jb dispatch
+		code.emit({ 0xB8, isFinal, 0x00, 0x00, 0x00 }); // mov eax, isFinal
+		code.emit({ 0xC3 }); // ret
+		emitDispatch(state, [&checkedLabels](size_t next) { return checkedLabels[next]; });
+
+		// Unrolled copies
+		for (size_t copy = 0; copy < kUnrollFactor; ++copy) {
+			code.place(unrolledLabels[state][copy]);
+			if (copy == 0) {
+				code.emit({ 0x4C, 0x39, 0xC7 }); // cmp rdi, r8
+				code.emit({ 0x0F, 0x87 }); code.jumpTo(checkedLabels[state]); // ja checked block
+			}
+			const size_t nextCopy = (copy + 1) % kUnrollFactor;
+			emitDispatch(state, [&unrolledLabels, nextCopy](size_t next) { return unrolledLabels[next][nextCopy]; });
+		}
+	}
+
+	code.place(rejectLabel);
+	code.emit({ 0x31, 0xC0 }); // xor eax, eax
+	code.emit({ 0xC3 }); // ret
+
+	// Lookup tables, starting on a page of their own
+	const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const size_t codeSize = (code.bytes.size() + pageSize - 1) / pageSize * pageSize;
+	code.bytes.resize(codeSize, 0xCC); // int3
+	for (const auto& [label, state] : classMaps) {
+		code.place(label);
+		unsigned char classIndex = 0;
+		for (size_t byte = 0; byte < kAlphabetSize; ++byte) {
+			int32_t next = m_table[state * kAlphabetSize + byte];
+			if (next != kDeadState) {
+				classIndex = static_cast<unsigned char>(std::find(classTargets[state].begin(), classTargets[state].end(), next) - classTargets[state].begin() + 1);
+			}
+			code.emit({ next == kDeadState ? static_cast<unsigned char>(0) : classIndex });
+		}
+	}
+	for (const auto& [label, classLabels] : targetTables) {
+		code.place(label);
+		const size_t tableStart = code.bytes.size();
+		for (size_t classLabel : classLabels) {
+			code.tableFixups.push_back({ code.bytes.size(), classLabel, tableStart });
+			code.emit32(0);
+		}
+	}
+	code.resolve();
+
+	void* memory = mmap(nullptr, code.bytes.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (memory == MAP_FAILED) return;
+	std::memcpy(memory, code.bytes.data(), code.bytes.size());
+	bool protectedPages = mprotect(memory, codeSize, PROT_READ | PROT_EXEC) == 0;
+	if (code.bytes.size() > codeSize) {
+		protectedPages = protectedPages && mprotect(static_cast<unsigned char*>(memory) + codeSize, code.bytes.size() - codeSize, PROT_READ) == 0;
+	}
+	if (!protectedPages) {
+		munmap(memory, code.bytes.size());
+		return;
+	}
+	m_nativeCode = std::make_unique<NativeCode>();
+	m_nativeCode->memory = memory;
+	m_nativeCode->size = code.bytes.size();
+	m_nativeCode->entry = reinterpret_cast<NativeMatcher>(memory);
+}
+
+#else
+
+void RegularExpression::CompiledAutomaton::CompileNative()
+{
+	// No native backend on this platform, CheckWord uses the table interpreter
+}
+
+#endif
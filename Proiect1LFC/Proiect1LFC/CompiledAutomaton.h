@@ -0,0 +1,79 @@
+#pragma once
+
+
+#include "Automaton.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// The JIT emits System V x86-64 code into mmap'd pages, so it only exists on Linux x86-64
+#if defined(__linux__) && defined(__x86_64__)
+#define REGULAR_EXPRESSION_JIT 1
+#else
+#define REGULAR_EXPRESSION_JIT 0
+#endif
+
+
+namespace RegularExpression {
+
+
+
+	class CompiledAutomaton
+	{
+
+
+	public:
+		//Constructors
+		CompiledAutomaton(const Automaton& dfa, bool enableJit = true);
+		CompiledAutomaton(const CompiledAutomaton&) = delete;
+		CompiledAutomaton(CompiledAutomaton&&) = default;
+		CompiledAutomaton& operator=(const CompiledAutomaton&) = delete;
+		CompiledAutomaton& operator=(CompiledAutomaton&&) = default;
+		~CompiledAutomaton() = default;
+
+		//Methods
+	public:
+		bool CheckWord(const std::string& word) const;
+		bool CheckWordInterpreted(const std::string& word) const;
+		bool IsJitCompiled() const;
+		size_t GetStatesCount() const;
+		int32_t GetInitialState() const;
+		int32_t GetNextState(int32_t state, unsigned char byte) const;
+		bool IsFinalState(int32_t state) const;
+
+	private:
+		//Building native code
+		void CompileNative();
+
+		//Constants
+	public:
+		static constexpr size_t kAlphabetSize = 256; //one column per byte
+		static constexpr int32_t kDeadState = -1;
+		static constexpr size_t kMaxJitStates = 256; //larger DFAs stay on the table interpreter
+		static constexpr size_t kUnrollFactor = 4; //bytes matched per bounds check in the native loop
+		static constexpr size_t kMaxCompareChain = 2; //more byte ranges than this use a lookup table, branch chains mispredict on varied input
+
+	private:
+		using NativeMatcher = bool(*)(const unsigned char* begin, const unsigned char* end);
+
+		struct NativeCode {
+		public:
+			void* memory = nullptr;
+			size_t size = 0;
+			NativeMatcher entry = nullptr; //start of memory, lives and moves with the pages it points into
+			~NativeCode();
+		};
+
+
+		//Atributes
+	private:
+		std::vector<int32_t> m_table; //m_table[state * kAlphabetSize + byte] = next state or kDeadState
+		std::vector<bool> m_finalStates; //m_finalStates[state] = state is final
+		int32_t m_initialState = kDeadState;
+		std::unique_ptr<NativeCode> m_nativeCode; //empty when running on the table interpreter
+
+
+	}; //END OF COMPILED AUTOMATON
+
+}
+
@@ -0,0 +1,97 @@
+// Compares Automaton::CheckWord, the flat table interpreter and the JIT on the same inputs.
+// Not part of the Visual Studio project (it has its own main), build it on Linux with:
+//   g++ -std=c++20 -O2 benchmark.cpp Automaton.cpp CompiledAutomaton.cpp -o benchmark
+//   ./benchmark "[a-zA-Z_].[a-zA-Z0-9_]*" 1000 100000
+
+#include "CompiledAutomaton.h"
+#include <chrono>
+#include <random>
+#include <functional>
+#include <string>
+#include <vector>
+
+double measureSeconds(const std::vector<std::string>& words, const std::function<bool(const std::string&)>& check, size_t& accepted) {
+    auto start = std::chrono::steady_clock::now();
+    accepted = 0;
+    for (const std::string& word : words) {
+        if (check(word)) ++accepted;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+
+    std::string expression = argc > 1 ? argv[1] : "[a-zA-Z_].[a-zA-Z0-9_]*";
+    size_t wordLength = argc > 2 ? std::stoul(argv[2]) : 1000;
+    size_t wordsCount = argc > 3 ? std::stoul(argv[3]) : 20000;
+
+    RegularExpression::Automaton automaton(expression);
+    RegularExpression::CompiledAutomaton compiled(automaton);
+
+    // Random walks over the DFA, restricted to states that can still reach a final state,
+    // so the words follow the expression whatever its alphabet is
+    const size_t statesCount = compiled.GetStatesCount();
+    std::vector<bool> live(statesCount, false);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int32_t state = 0; state < static_cast<int32_t>(statesCount); ++state) {
+            if (live[state]) continue;
+            bool reachesFinal = compiled.IsFinalState(state);
+            for (unsigned int byte = 0; byte < 256 && !reachesFinal; ++byte) {
+                int32_t next = compiled.GetNextState(state, static_cast<unsigned char>(byte));
+                reachesFinal = next != RegularExpression::CompiledAutomaton::kDeadState && live[next];
+            }
+            if (reachesFinal) live[state] = changed = true;
+        }
+    }
+
+    std::vector<std::vector<unsigned char>> choices(statesCount); //bytes leading to a live state
+    for (int32_t state = 0; state < static_cast<int32_t>(statesCount); ++state) {
+        for (unsigned int byte = 0; byte < 256; ++byte) {
+            int32_t next = compiled.GetNextState(state, static_cast<unsigned char>(byte));
+            if (next != RegularExpression::CompiledAutomaton::kDeadState && live[next]) choices[state].push_back(static_cast<unsigned char>(byte));
+        }
+    }
+
+    std::mt19937 generator(42);
+    std::vector<std::string> words(wordsCount);
+    for (std::string& word : words) {
+        int32_t state = compiled.GetInitialState();
+        // Walk wordLength bytes, then keep going until a final state (at most wordLength more)
+        while (state != RegularExpression::CompiledAutomaton::kDeadState && live[state]) {
+            if (word.size() >= wordLength && compiled.IsFinalState(state)) break;
+            if (word.size() >= 2 * wordLength) break;
+            if (choices[state].empty()) break;
+            unsigned char byte = choices[state][generator() % choices[state].size()];
+            word.push_back(static_cast<char>(byte));
+            state = compiled.GetNextState(state, byte);
+        }
+        // Corrupt a quarter of the words so rejection is measured too
+        if (!word.empty() && generator() % 4 == 0) word[generator() % word.size()] = static_cast<char>(generator() % 256);
+    }
+
+    std::cout << "Expression: " << expression << "\n";
+    std::cout << "DFA states: " << compiled.GetStatesCount() << (compiled.IsJitCompiled() ? " (JIT)" : " (no JIT, interpreter fallback)") << "\n";
+    std::cout << "Input: " << wordsCount << " words of about " << wordLength << " bytes\n\n";
+
+    size_t acceptedMap = 0, acceptedTable = 0, acceptedNative = 0;
+    double mapSeconds = measureSeconds(words, [&automaton](const std::string& word) { return automaton.CheckWord(word); }, acceptedMap);
+    double tableSeconds = measureSeconds(words, [&compiled](const std::string& word) { return compiled.CheckWordInterpreted(word); }, acceptedTable);
+    double nativeSeconds = measureSeconds(words, [&compiled](const std::string& word) { return compiled.CheckWord(word); }, acceptedNative);
+
+    size_t totalBytes = 0;
+    for (const std::string& word : words) totalBytes += word.size();
+    const double megabytes = static_cast<double>(totalBytes) / (1 << 20);
+    std::cout << "Automaton::CheckWord : " << megabytes / mapSeconds << " MB/s, accepted " << acceptedMap << "\n";
+    std::cout << "Table interpreter    : " << megabytes / tableSeconds << " MB/s, accepted " << acceptedTable << "\n";
+    std::cout << "JIT                  : " << megabytes / nativeSeconds << " MB/s, accepted " << acceptedNative << "\n";
+
+    if (acceptedMap != acceptedTable || acceptedTable != acceptedNative) {
+        std::cout << "\nMISMATCH between matchers!\n";
+        return 1;
+    }
+    if (acceptedNative * 100 < wordsCount) {
+        std::cout << "\nWarning: less than 1% of the words were accepted, the matchers mostly stop early and the figures are not meaningful.\n";
+    }
+    return 0;
+}
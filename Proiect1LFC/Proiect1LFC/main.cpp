@@ -17,6 +17,9 @@ void printRegexExplanation(const std::string& regex) {
     if (regex.find('.') != std::string::npos) {
         std::cout << "- The '.' symbol marks the concatenation of sequences.\n";
     }
+    if (regex.find('[') != std::string::npos) {
+        std::cout << "- The '[...]' brackets match one character from a list or lo-hi range (UTF-8 allowed).\n";
+    }
 }
 
 int main() {